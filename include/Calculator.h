@@ -9,6 +9,7 @@
 #include "Constants.h"
 #include "Button.h"
 #include "ExpressionEvaluator.h"
+#include "Resources.h"
 
 class Calculator : public sf::Drawable, public sf::Transformable
 {
@@ -24,7 +25,7 @@ public:
         display->setOutlineThickness(2);
 
         // Создаем текстовое поле в дисплее
-        displayText = std::make_unique<sf::Text>("", font, 30);
+        displayText = std::make_unique<sf::Text>("", font, DISPLAY_CHARACTER_SIZE);
         displayText->setPosition(30, 30);
         displayText->setFillColor(sf::Color::Black);
 
@@ -46,6 +47,9 @@ public:
             "0", "(", ")", "+",
             "C", "<", "="};
 
+        // Растеризуем глифы заранее, одним проходом
+        warmUpGlyphs(font, labels);
+
         // Создаем кнопки
         buttons.reserve(labels.size());
         for (size_t i = 0; i < labels.size(); ++i)
@@ -69,14 +73,14 @@ public:
             }
 
             buttons.emplace_back(std::make_unique<Button>(
-                labels[i], font, 24,
+                labels[i], font, BUTTON_CHARACTER_SIZE,
                 sf::Vector2f(20 + (i % 4) * 90, 100 + (i / 4) * 90),
                 sf::Vector2f(80, 80), color));
         }
 
         // Загружаем текстуру логотипа
         logoTexture = std::make_unique<sf::Texture>();
-        if (!logoTexture->loadFromFile("../resources/images/logo.png"))
+        if (!Resources::loadLogo(*logoTexture))
         {
             std::cerr << "Ошибка при загрузке логотипа!" << std::endl;
         }
@@ -126,6 +130,21 @@ public:
     }
 
 private:
+    // Предварительная растеризация глифов кнопок и дисплея
+    static void warmUpGlyphs(sf::Font &font, const std::vector<std::string> &labels)
+    {
+        for (const auto &label : labels)
+        {
+            for (char c : label)
+                font.getGlyph(static_cast<unsigned char>(c), BUTTON_CHARACTER_SIZE, false);
+        }
+
+        // Символы, которые могут появиться на дисплее
+        std::string_view displayChars = "0123456789+-*/().Error";
+        for (char c : displayChars)
+            font.getGlyph(static_cast<unsigned char>(c), DISPLAY_CHARACTER_SIZE, false);
+    }
+
     // Метод отрисовки калькулятора
     void draw(sf::RenderTarget &target, sf::RenderStates states) const override
     {
@@ -160,14 +179,7 @@ private:
             try
             {
                 double result = ExpressionEvaluator::evaluate(input);
-                input = std::to_string(result);
-                // Убираем лишние нули после точки
-                if (input.find('.') != std::string::npos)
-                {
-                    input.erase(input.find_last_not_of('0') + 1, std::string::npos);
-                    if (input.back() == '.')
-                        input.pop_back();
-                }
+                input = ExpressionEvaluator::toString(result);
                 isResult = true;
             }
             catch (const std::exception &)
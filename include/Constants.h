@@ -4,3 +4,5 @@ constexpr float WINDOW_WIDTH = 390;
 constexpr float WINDOW_HEIGHT = 570;
 constexpr float DISPLAY_WIDTH = 350;
 constexpr float DISPLAY_HEIGHT = 50;
+constexpr unsigned int BUTTON_CHARACTER_SIZE = 24;
+constexpr unsigned int DISPLAY_CHARACTER_SIZE = 30;
@@ -0,0 +1,55 @@
+// Протокол сервера вычислений
+// Кадр: длина нагрузки (4 байта, big-endian), затем сама нагрузка.
+// Запрос содержит выражение, ответ - байт статуса и результат или текст ошибки
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+
+namespace EvaluationProtocol
+{
+    constexpr const char *DEFAULT_SOCKET_PATH = "/tmp/sfml-calc.sock";
+
+    constexpr std::size_t HEADER_SIZE = 4;
+    constexpr std::uint32_t MAX_PAYLOAD_SIZE = 64 * 1024;
+
+    // Первый байт нагрузки ответа
+    constexpr char STATUS_OK = 0;
+    constexpr char STATUS_ERROR = 1;
+
+    // Добавляет кадр с нагрузкой в конец буфера
+    inline void appendFrame(std::string &buffer, std::string_view payload)
+    {
+        const auto size = static_cast<std::uint32_t>(payload.size());
+        buffer += static_cast<char>(size >> 24);
+        buffer += static_cast<char>(size >> 16);
+        buffer += static_cast<char>(size >> 8);
+        buffer += static_cast<char>(size);
+        buffer += payload;
+    }
+
+    // Извлекает очередной кадр, начиная с offset.
+    // Возвращает false, если кадр еще не получен целиком
+    inline bool nextFrame(std::string_view buffer, std::size_t &offset, std::string_view &payload)
+    {
+        if (buffer.size() - offset < HEADER_SIZE)
+            return false;
+
+        const auto *header = reinterpret_cast<const unsigned char *>(buffer.data() + offset);
+        const std::uint32_t size = (std::uint32_t{header[0]} << 24) | (std::uint32_t{header[1]} << 16) |
+                                   (std::uint32_t{header[2]} << 8) | std::uint32_t{header[3]};
+
+        if (size > MAX_PAYLOAD_SIZE)
+            throw std::length_error("Слишком длинный кадр");
+
+        if (buffer.size() - offset - HEADER_SIZE < size)
+            return false;
+
+        payload = buffer.substr(offset + HEADER_SIZE, size);
+        offset += HEADER_SIZE + size;
+        return true;
+    }
+}
@@ -0,0 +1,498 @@
+// Сервер вычислений на Unix domain socket
+// Держит ExpressionEvaluator и кэш результатов в памяти процесса
+// и обслуживает конвейерные запросы в цикле событий epoll
+
+#pragma once
+#ifdef __linux__
+
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/timerfd.h>
+#include <sys/un.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "ExpressionEvaluator.h"
+#include "EvaluationProtocol.h"
+
+class EvaluationServer
+{
+public:
+    // Конструктор сервера: создает сокет и начинает прослушивание
+    explicit EvaluationServer(std::string path) : socketPath(std::move(path))
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (socketPath.empty() || socketPath.size() >= sizeof(address.sun_path))
+            throw std::invalid_argument("Некорректный путь к сокету");
+        std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+        // Сигналы завершения принимаем через signalfd, чтобы корректно удалить сокет.
+        // Блокируем их до создания файла сокета, иначе сигнал оставит его на диске
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        if (::sigprocmask(SIG_BLOCK, &signals, nullptr) < 0)
+            throwSystemError("sigprocmask");
+
+        signalFd = FileDescriptor(::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC));
+        if (!signalFd)
+            throwSystemError("signalfd");
+
+        epollFd = FileDescriptor(::epoll_create1(EPOLL_CLOEXEC));
+        if (!epollFd)
+            throwSystemError("epoll_create1");
+
+        // Таймер возобновления приема подключений после нехватки ресурсов
+        acceptTimerFd = FileDescriptor(::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC));
+        if (!acceptTimerFd)
+            throwSystemError("timerfd_create");
+
+        // Запасной дескриптор освобождается, чтобы принять и сразу закрыть
+        // подключение, когда дескрипторы процесса закончились
+        spareFd = FileDescriptor(::open("/dev/null", O_RDONLY | O_CLOEXEC));
+
+        if (!watch(EPOLL_CTL_ADD, signalFd.get(), EPOLLIN) ||
+            !watch(EPOLL_CTL_ADD, acceptTimerFd.get(), EPOLLIN))
+            throwSystemError("epoll_ctl");
+
+        listenFd = FileDescriptor(::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0));
+        if (!listenFd)
+            throwSystemError("socket");
+
+        removeStaleSocket(address);
+        if (::bind(listenFd.get(), reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+            throwSystemError("bind");
+
+        // Деструктор при исключении из конструктора не вызывается,
+        // поэтому созданный файл сокета удаляем здесь
+        try
+        {
+            if (::listen(listenFd.get(), SOMAXCONN) < 0)
+                throwSystemError("listen");
+
+            if (!watch(EPOLL_CTL_ADD, listenFd.get(), EPOLLIN))
+                throwSystemError("epoll_ctl");
+        }
+        catch (...)
+        {
+            ::unlink(socketPath.c_str());
+            throw;
+        }
+        isBound = true;
+    }
+
+    EvaluationServer(const EvaluationServer &) = delete;
+    EvaluationServer &operator=(const EvaluationServer &) = delete;
+
+    ~EvaluationServer()
+    {
+        if (isBound)
+            ::unlink(socketPath.c_str());
+    }
+
+    // Цикл обработки событий, работает до получения SIGINT или SIGTERM
+    void run()
+    {
+        std::array<epoll_event, 64> events;
+
+        while (true)
+        {
+            int count = ::epoll_wait(epollFd.get(), events.data(), static_cast<int>(events.size()), -1);
+            if (count < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                throwSystemError("epoll_wait");
+            }
+
+            for (int i = 0; i < count; ++i)
+            {
+                const int fd = events[i].data.fd;
+
+                if (fd == signalFd.get())
+                    return;
+
+                if (fd == listenFd.get())
+                {
+                    acceptConnections();
+                    continue;
+                }
+
+                if (fd == acceptTimerFd.get())
+                {
+                    uint64_t expirations;
+                    [[maybe_unused]] ssize_t size = ::read(fd, &expirations, sizeof(expirations));
+                    resumeAccepting();
+                    continue;
+                }
+
+                auto it = connections.find(fd);
+                if (it != connections.end() && !serviceConnection(it->second, events[i].events))
+                {
+                    connections.erase(it); // Закрытый дескриптор сам удаляется из epoll
+                    resumeAccepting();
+                }
+            }
+        }
+    }
+
+private:
+    // Владелец файлового дескриптора
+    class FileDescriptor
+    {
+    public:
+        FileDescriptor() = default;
+        explicit FileDescriptor(int fd) : fd(fd) {}
+        FileDescriptor(FileDescriptor &&other) noexcept : fd(std::exchange(other.fd, -1)) {}
+
+        FileDescriptor &operator=(FileDescriptor &&other) noexcept
+        {
+            std::swap(fd, other.fd);
+            return *this;
+        }
+
+        ~FileDescriptor()
+        {
+            if (fd >= 0)
+                ::close(fd);
+        }
+
+        int get() const { return fd; }
+        explicit operator bool() const { return fd >= 0; }
+
+    private:
+        int fd = -1;
+    };
+
+    // Состояние клиентского соединения
+    struct Connection
+    {
+        FileDescriptor fd;
+        std::string input;       // Принятые, но еще не разобранные байты
+        std::string output;      // Ответы, ожидающие отправки
+        uint32_t events = 0;     // Текущая подписка в epoll
+        bool peerClosed = false; // Клиент закрыл свою сторону соединения
+    };
+
+    // Хэш для поиска в кэше по std::string_view без копирования ключа
+    struct StringHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view text) const { return std::hash<std::string_view>{}(text); }
+    };
+
+    static constexpr size_t READ_BATCH = 16;                   // Чтений за одно событие
+    static constexpr size_t MAX_PENDING_OUTPUT = 1024 * 1024;  // Порог приостановки чтения
+    static constexpr size_t MAX_CACHE_SIZE = 4096;             // Записей в кэше результатов
+    static constexpr long ACCEPT_RETRY_DELAY_NS = 100'000'000; // Пауза приема при нехватке ресурсов
+
+    [[noreturn]] static void throwSystemError(const char *what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // Удаляет сокет, оставшийся от завершившегося сервера.
+    // Обычные файлы и сокеты работающего сервера не трогает
+    static void removeStaleSocket(const sockaddr_un &address)
+    {
+        struct stat status{};
+        if (::lstat(address.sun_path, &status) < 0)
+        {
+            if (errno == ENOENT)
+                return;
+            throwSystemError("lstat");
+        }
+
+        if (!S_ISSOCK(status.st_mode))
+            throw std::runtime_error("Путь к сокету занят файлом другого типа");
+
+        FileDescriptor probe(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        if (!probe)
+            throwSystemError("socket");
+
+        if (::connect(probe.get(), reinterpret_cast<const sockaddr *>(&address), sizeof(address)) == 0)
+            throw std::runtime_error("Сокет уже используется другим сервером");
+
+        if (errno != ECONNREFUSED)
+            throwSystemError("connect");
+
+        if (::unlink(address.sun_path) < 0)
+            throwSystemError("unlink");
+    }
+
+    bool watch(int operation, int fd, uint32_t events)
+    {
+        epoll_event event{};
+        event.events = events;
+        event.data.fd = fd;
+        return ::epoll_ctl(epollFd.get(), operation, fd, &event) == 0;
+    }
+
+    // Нехватка дескрипторов или памяти не должна останавливать сервер
+    static bool isResourceError(int error)
+    {
+        return error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM;
+    }
+
+    // Приостановка приема подключений до закрытия соединения или срабатывания таймера
+    void pauseAccepting()
+    {
+        if (acceptPaused || !watch(EPOLL_CTL_MOD, listenFd.get(), 0))
+            return;
+
+        itimerspec delay{};
+        delay.it_value.tv_nsec = ACCEPT_RETRY_DELAY_NS;
+        delay.it_interval.tv_nsec = ACCEPT_RETRY_DELAY_NS;
+        ::timerfd_settime(acceptTimerFd.get(), 0, &delay, nullptr);
+        acceptPaused = true;
+    }
+
+    // Возобновление приема подключений
+    void resumeAccepting()
+    {
+        if (!acceptPaused || !watch(EPOLL_CTL_MOD, listenFd.get(), EPOLLIN))
+            return;
+
+        itimerspec disarm{};
+        ::timerfd_settime(acceptTimerFd.get(), 0, &disarm, nullptr);
+        acceptPaused = false;
+    }
+
+    // Отклонение ожидающего подключения через запасной дескриптор.
+    // Возвращает 0, если подключение принято и закрыто, иначе код ошибки accept4
+    int rejectWithSpareFd()
+    {
+        spareFd = FileDescriptor();
+        FileDescriptor rejected(::accept4(listenFd.get(), nullptr, nullptr, SOCK_CLOEXEC));
+        const int error = rejected ? 0 : errno;
+        rejected = FileDescriptor();
+        spareFd = FileDescriptor(::open("/dev/null", O_RDONLY | O_CLOEXEC));
+        return error;
+    }
+
+    // Прием всех ожидающих подключений
+    void acceptConnections()
+    {
+        while (true)
+        {
+            FileDescriptor fd(::accept4(listenFd.get(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC));
+            if (!fd)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    return;
+                if (!isResourceError(errno))
+                    throwSystemError("accept4");
+
+                // Сообщаем только о первой ошибке подряд, чтобы не засорять журнал
+                const int error = errno;
+                if (!acceptErrorReported)
+                {
+                    std::cerr << "Ошибка accept4: " << std::strerror(error) << "\n";
+                    acceptErrorReported = true;
+                }
+
+                // Слушающий сокет остается готовым к чтению, поэтому клиента нужно
+                // отклонить или снять сокет с наблюдения, иначе epoll зациклится.
+                // EMFILE возвращается и при пустой очереди, это видно по EAGAIN
+                if ((error == EMFILE || error == ENFILE) && spareFd)
+                {
+                    const int rejectError = rejectWithSpareFd();
+                    if (rejectError == 0)
+                        continue;
+                    if (rejectError == EAGAIN || rejectError == EWOULDBLOCK)
+                        return;
+                }
+
+                pauseAccepting();
+                return;
+            }
+            acceptErrorReported = false;
+
+            const int key = fd.get();
+            if (!watch(EPOLL_CTL_ADD, key, EPOLLIN))
+            {
+                std::cerr << "Ошибка epoll_ctl: " << std::strerror(errno) << "\n";
+                continue; // Дескриптор закроется вместе с fd
+            }
+
+            Connection connection;
+            connection.fd = std::move(fd);
+            connection.events = EPOLLIN;
+            connections.insert_or_assign(key, std::move(connection));
+        }
+    }
+
+    // Обработка события соединения. Возвращает false, если соединение нужно закрыть
+    bool serviceConnection(Connection &connection, uint32_t events)
+    {
+        if (events & EPOLLERR)
+            return false;
+
+        if ((events & (EPOLLIN | EPOLLHUP)) && !readRequests(connection))
+            return false;
+
+        if (!connection.output.empty() && !writeResponses(connection))
+            return false;
+
+        if (connection.peerClosed && connection.output.empty())
+            return false;
+
+        // Подписываемся на запись только при наличии неотправленных ответов,
+        // а чтение приостанавливаем, пока клиент не заберет накопленное
+        uint32_t wanted = 0;
+        if (!connection.peerClosed && connection.output.size() < MAX_PENDING_OUTPUT)
+            wanted |= EPOLLIN;
+        if (!connection.output.empty())
+            wanted |= EPOLLOUT;
+
+        if (wanted != connection.events)
+        {
+            if (!watch(EPOLL_CTL_MOD, connection.fd.get(), wanted))
+                return false;
+            connection.events = wanted;
+        }
+        return true;
+    }
+
+    // Пакетное чтение запросов и вычисление всех полученных кадров
+    bool readRequests(Connection &connection)
+    {
+        for (size_t i = 0; i < READ_BATCH && connection.output.size() < MAX_PENDING_OUTPUT; ++i)
+        {
+            ssize_t received = ::recv(connection.fd.get(), readBuffer.data(), readBuffer.size(), 0);
+            if (received > 0)
+            {
+                connection.input.append(readBuffer.data(), static_cast<size_t>(received));
+                if (!processRequests(connection))
+                    return false;
+                continue;
+            }
+
+            if (received == 0)
+            {
+                connection.peerClosed = true;
+                break;
+            }
+
+            if (errno == EINTR)
+                continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK)
+                break;
+            return false;
+        }
+        return true;
+    }
+
+    // Разбор полностью принятых кадров, ответы копятся в выходном буфере
+    bool processRequests(Connection &connection)
+    {
+        size_t offset = 0;
+        std::string_view payload;
+        try
+        {
+            while (EvaluationProtocol::nextFrame(connection.input, offset, payload))
+                respond(connection.output, payload);
+        }
+        catch (const std::length_error &)
+        {
+            return false; // Клиент нарушил протокол
+        }
+
+        connection.input.erase(0, offset);
+        return true;
+    }
+
+    // Отправка накопленных ответов одним системным вызовом, если сокет позволяет
+    bool writeResponses(Connection &connection)
+    {
+        size_t written = 0;
+        while (written < connection.output.size())
+        {
+            ssize_t sent = ::send(connection.fd.get(), connection.output.data() + written,
+                                  connection.output.size() - written, MSG_NOSIGNAL);
+            if (sent < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                    break;
+                return false;
+            }
+            written += static_cast<size_t>(sent);
+        }
+
+        connection.output.erase(0, written);
+        return true;
+    }
+
+    // Вычисление выражения и добавление ответа в выходной буфер.
+    // Кэшируются только результаты и ошибки разбора: они зависят лишь от текста выражения
+    void respond(std::string &output, std::string_view expression)
+    {
+        if (auto it = cache.find(expression); it != cache.end())
+        {
+            EvaluationProtocol::appendFrame(output, it->second);
+            return;
+        }
+
+        std::string response;
+        try
+        {
+            response += EvaluationProtocol::STATUS_OK;
+            response += ExpressionEvaluator::toExactString(ExpressionEvaluator::evaluate(expression));
+        }
+        catch (const std::invalid_argument &error)
+        {
+            response.assign(1, EvaluationProtocol::STATUS_ERROR);
+            response += error.what();
+        }
+        catch (const std::exception &error)
+        {
+            // Временный сбой (например, нехватка памяти) в кэш не попадает
+            response.assign(1, EvaluationProtocol::STATUS_ERROR);
+            response += error.what();
+            EvaluationProtocol::appendFrame(output, response);
+            return;
+        }
+
+        if (cache.size() >= MAX_CACHE_SIZE)
+            cache.clear();
+
+        EvaluationProtocol::appendFrame(output, response);
+        cache.emplace(expression, std::move(response));
+    }
+
+    std::string socketPath;           // Путь к файлу сокета
+    bool isBound = false;             // Файл сокета создан этим процессом
+    bool acceptPaused = false;        // Прием подключений приостановлен из-за нехватки ресурсов
+    bool acceptErrorReported = false; // Ошибка accept4 уже выведена в журнал
+
+    FileDescriptor listenFd;      // Слушающий сокет
+    FileDescriptor signalFd;      // Сигналы завершения
+    FileDescriptor epollFd;       // Экземпляр epoll
+    FileDescriptor acceptTimerFd; // Таймер возобновления приема
+    FileDescriptor spareFd;       // Запасной дескриптор для отклонения подключений
+
+    std::unordered_map<int, Connection> connections;                                  // Соединения
+    std::unordered_map<std::string, std::string, StringHash, std::equal_to<>> cache; // Кэш ответов
+    std::array<char, 64 * 1024> readBuffer;                                          // Буфер чтения
+};
+
+#endif
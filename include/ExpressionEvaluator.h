@@ -15,7 +15,7 @@ public:
     static double evaluate(std::string_view expression)
     {
         size_t pos = 0;
-        double result = parseExpression(expression, pos);
+        double result = parseExpression(expression, pos, 0);
 
         // Проверяем, что выражение обработано полностью
         skipWhitespace(expression, pos);
@@ -27,22 +27,47 @@ public:
         return result;
     }
 
+    // Преобразование результата в строку без лишних нулей после точки
+    static std::string toString(double value)
+    {
+        std::string text = std::to_string(value);
+        if (text.find('.') != std::string::npos)
+        {
+            text.erase(text.find_last_not_of('0') + 1, std::string::npos);
+            if (text.back() == '.')
+                text.pop_back();
+        }
+        return text;
+    }
+
+    // Кратчайшая запись результата, из которой число восстанавливается без потерь
+    static std::string toExactString(double value)
+    {
+        char buffer[32];
+        auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, ptr);
+    }
+
 private:
+    static constexpr size_t MAX_DEPTH = 256; // Предельная вложенность скобок
+
     // Обработка сложения и вычитания
-    static double parseExpression(std::string_view expr, size_t &pos)
+    static double parseExpression(std::string_view expr, size_t &pos, size_t depth)
     {
-        double result = parseTerm(expr, pos);
+        double result = parseTerm(expr, pos, depth);
 
         while (pos < expr.length())
         {
             skipWhitespace(expr, pos);
+            if (pos >= expr.length())
+                break;
 
             char op = expr[pos];
             if (op != '+' && op != '-')
                 break;
 
             pos++;
-            double term = parseTerm(expr, pos);
+            double term = parseTerm(expr, pos, depth);
             result = (op == '+') ? result + term : result - term;
         }
 
@@ -50,20 +75,22 @@ private:
     }
 
     // Обработка умножения и деления
-    static double parseTerm(std::string_view expr, size_t &pos)
+    static double parseTerm(std::string_view expr, size_t &pos, size_t depth)
     {
-        double result = parseFactor(expr, pos);
+        double result = parseFactor(expr, pos, depth);
 
         while (pos < expr.length())
         {
             skipWhitespace(expr, pos);
+            if (pos >= expr.length())
+                break;
 
             char op = expr[pos];
             if (op != '*' && op != '/')
                 break;
 
             pos++;
-            double factor = parseFactor(expr, pos);
+            double factor = parseFactor(expr, pos, depth);
 
             if (op == '*')
                 result *= factor;
@@ -77,7 +104,7 @@ private:
     }
 
     // Обработка чисел и скобок
-    static double parseFactor(std::string_view expr, size_t &pos)
+    static double parseFactor(std::string_view expr, size_t &pos, size_t depth)
     {
         skipWhitespace(expr, pos);
 
@@ -87,8 +114,12 @@ private:
         // Обработка скобок
         if (expr[pos] == '(')
         {
+            // Ограничиваем рекурсию, чтобы глубокая вложенность не переполнила стек
+            if (depth >= MAX_DEPTH)
+                throw std::invalid_argument("Слишком глубокая вложенность скобок");
+
             pos++;
-            double result = parseExpression(expr, pos);
+            double result = parseExpression(expr, pos, depth + 1);
             skipWhitespace(expr, pos);
 
             if (pos >= expr.length() || expr[pos] != ')')
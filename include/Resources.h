@@ -0,0 +1,41 @@
+// Загрузка ресурсов приложения
+// Шрифт и логотип берутся из бинарника или с диска
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+#ifdef SFML_CALC_EMBED_RESOURCES
+#include "EmbeddedResources.h" // Генерируется tools/embed_resources.cpp
+#endif
+
+namespace Resources
+{
+    constexpr const char *FONT_PATH = "../resources/fonts/arial.ttf";
+    constexpr const char *LOGO_PATH = "../resources/images/logo.png";
+
+    // Загрузка шрифта
+    inline bool loadFont(sf::Font &font)
+    {
+#ifdef SFML_CALC_EMBED_RESOURCES
+        // SFML не копирует данные шрифта, поэтому массив должен жить до конца программы
+        return font.loadFromMemory(Embedded::FONT_DATA, sizeof(Embedded::FONT_DATA));
+#else
+        return font.loadFromFile(FONT_PATH);
+#endif
+    }
+
+    // Загрузка логотипа
+    inline bool loadLogo(sf::Texture &texture)
+    {
+#ifdef SFML_CALC_EMBED_RESOURCES
+        // Пиксели уже декодированы в RGBA, PNG при запуске не разбирается
+        if (!texture.create(Embedded::LOGO_WIDTH, Embedded::LOGO_HEIGHT))
+            return false;
+
+        texture.update(Embedded::LOGO_PIXELS);
+        return true;
+#else
+        return texture.loadFromFile(LOGO_PATH);
+#endif
+    }
+}
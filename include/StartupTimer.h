@@ -0,0 +1,136 @@
+// Замер времени холодного старта
+// Отсчет ведется от создания процесса (по данным ОС) до первого кадра
+
+#pragma once
+#include <chrono>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <fstream>
+#include <sstream>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+class StartupTimer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Отметка завершения этапа запуска
+    void mark(std::string stage)
+    {
+        stages.emplace_back(std::move(stage), Clock::now());
+    }
+
+    // Вывод отчета по этапам
+    void report(std::ostream &out) const
+    {
+        if (origin.fromProcessStart)
+            out << "Время запуска (от создания процесса):\n";
+        else
+            out << "Время запуска (от статической инициализации, время создания процесса недоступно):\n";
+
+        Clock::time_point previous = origin.time;
+        for (const auto &[stage, time] : stages)
+        {
+            out << "  " << stage << ": " << milliseconds(time - previous)
+                << " мс (с начала " << milliseconds(time - origin.time) << " мс)\n";
+            previous = time;
+        }
+    }
+
+private:
+    // Точка отсчета замера
+    struct Origin
+    {
+        Clock::time_point time;
+        bool fromProcessStart; // false - запасной вариант, статическая инициализация
+    };
+
+    static double milliseconds(Clock::duration duration)
+    {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    // Время, прошедшее с создания процесса. Включает загрузку DLL SFML, OpenGL и FreeType,
+    // которая происходит до статической инициализации программы
+    static std::optional<Clock::duration> processAge()
+    {
+#if defined(_WIN32)
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            return std::nullopt;
+
+        FILETIME now;
+        GetSystemTimePreciseAsFileTime(&now);
+
+        // FILETIME хранит время в интервалах по 100 нс
+        auto ticks = [](FILETIME time)
+        {
+            return (static_cast<unsigned long long>(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+        };
+        if (ticks(now) < ticks(creation))
+            return std::nullopt;
+
+        using FileTimeTicks = std::chrono::duration<unsigned long long, std::ratio<1, 10'000'000>>;
+        return std::chrono::duration_cast<Clock::duration>(FileTimeTicks(ticks(now) - ticks(creation)));
+#elif defined(__linux__)
+        // Поле 22 в /proc/self/stat - момент запуска в тиках с загрузки системы.
+        // Имя процесса в скобках может содержать пробелы, поэтому разбор идет после ')'
+        std::ifstream file("/proc/self/stat");
+        std::string content;
+        if (!std::getline(file, content))
+            return std::nullopt;
+
+        const size_t nameEnd = content.rfind(')');
+        if (nameEnd == std::string::npos)
+            return std::nullopt;
+
+        std::istringstream fields(content.substr(nameEnd + 1));
+        std::string skipped;
+        for (int field = 3; field < 22; ++field)
+            fields >> skipped;
+
+        unsigned long long startTicks = 0;
+        const long ticksPerSecond = ::sysconf(_SC_CLK_TCK);
+        timespec uptime{};
+        if (!(fields >> startTicks) || ticksPerSecond <= 0 || ::clock_gettime(CLOCK_BOOTTIME, &uptime) != 0)
+            return std::nullopt;
+
+        const auto started = std::chrono::nanoseconds(startTicks * 1'000'000'000ULL / ticksPerSecond);
+        const auto now = std::chrono::seconds(uptime.tv_sec) + std::chrono::nanoseconds(uptime.tv_nsec);
+        if (now < started)
+            return std::nullopt;
+
+        return std::chrono::duration_cast<Clock::duration>(now - started);
+#else
+        return std::nullopt;
+#endif
+    }
+
+    static Origin detectOrigin()
+    {
+        const Clock::time_point now = Clock::now();
+        if (auto age = processAge())
+            return {now - *age, true};
+        return {now, false};
+    }
+
+    // Инициализируется до вызова main()
+    static inline const Origin origin = detectOrigin();
+
+    std::vector<std::pair<std::string, Clock::time_point>> stages; // Этапы запуска
+};
@@ -1,23 +1,81 @@
 #include <SFML/Graphics.hpp>
 #include <iostream>
+#include <string>
+#include <string_view>
 #include "../include/Constants.h"
 #include "../include/Calculator.h"
+#include "../include/EvaluationProtocol.h"
+#include "../include/EvaluationServer.h"
+#include "../include/Resources.h"
+#include "../include/StartupTimer.h"
 
-int main()
+// Запуск сервера вычислений без графического интерфейса
+static int runServer(const std::string &socketPath)
 {
+#ifdef __linux__
+    try
+    {
+        EvaluationServer server(socketPath);
+        std::cerr << "Сервер вычислений ожидает запросы на " << socketPath << "\n";
+        server.run();
+        return 0;
+    }
+    catch (const std::exception &error)
+    {
+        std::cerr << "Ошибка сервера: " << error.what() << "\n";
+        return -1;
+    }
+#else
+    std::cerr << "Режим --serve поддерживается только в Linux\n";
+    return -1;
+#endif
+}
+
+int main(int argc, char *argv[])
+{
+    // Отчет о времени запуска включается флагом --startup-report,
+    // режим сервера - флагом --serve с необязательным путем к сокету
+    bool startupReport = false;
+    bool serve = false;
+    std::string socketPath = EvaluationProtocol::DEFAULT_SOCKET_PATH;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg(argv[i]);
+        if (arg == "--startup-report")
+        {
+            startupReport = true;
+        }
+        else if (arg == "--serve")
+        {
+            serve = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                socketPath = argv[++i];
+        }
+    }
+
+    if (serve)
+        return runServer(socketPath);
+
+    StartupTimer startupTimer;
+
     // Создаем окно приложения с заданными параметрами
     sf::RenderWindow window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), L"SFML Калькулятор");
+    startupTimer.mark("Создание окна");
 
     // Загружаем шрифт
     std::unique_ptr<sf::Font> font = std::make_unique<sf::Font>();
-    if (!font->loadFromFile("../resources/fonts/arial.ttf"))
+    if (!Resources::loadFont(*font))
     {
         std::cerr << "Ошибка при загрузке шрифта!\n";
         return -1;
     }
+    startupTimer.mark("Загрузка шрифта");
 
     // Создаем экземпляр калькулятора, передавая ему шрифт
     Calculator calculator(*font);
+    startupTimer.mark("Создание калькулятора");
+
+    bool firstFrame = true;
 
     // Главный цикл приложения
     while (window.isOpen())
@@ -44,6 +102,14 @@ int main()
         window.clear(sf::Color::White);
         window.draw(calculator);
         window.display();
+
+        if (firstFrame)
+        {
+            firstFrame = false;
+            startupTimer.mark("Первый кадр");
+            if (startupReport)
+                startupTimer.report(std::cerr);
+        }
     }
     return 0;
 }
@@ -0,0 +1,71 @@
+// Генератор заголовка со встроенными ресурсами
+// Упаковывает шрифт и заранее декодированный логотип в массивы C++
+
+#include <SFML/Graphics.hpp>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Запись массива байтов в виде литерала
+static void writeArray(std::ostream &out, const char *name, const sf::Uint8 *data, std::size_t size)
+{
+    out << "inline constexpr unsigned char " << name << "[] = {";
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (i % 16 == 0)
+            out << "\n    ";
+        out << static_cast<unsigned int>(data[i]) << ',';
+    }
+    out << "\n};\n\n";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Использование: embed-resources <каталог resources> <выходной заголовок>\n";
+        return -1;
+    }
+
+    const std::string resources = argv[1];
+
+    // Читаем файл шрифта целиком
+    std::ifstream fontFile(resources + "/fonts/arial.ttf", std::ios::binary);
+    if (!fontFile)
+    {
+        std::cerr << "Ошибка при загрузке шрифта!\n";
+        return -1;
+    }
+    const std::vector<sf::Uint8> font{std::istreambuf_iterator<char>(fontFile),
+                                      std::istreambuf_iterator<char>()};
+
+    // Декодируем логотип в RGBA
+    sf::Image logo;
+    if (!logo.loadFromFile(resources + "/images/logo.png"))
+    {
+        std::cerr << "Ошибка при загрузке логотипа!\n";
+        return -1;
+    }
+    const sf::Vector2u logoSize = logo.getSize();
+
+    std::ofstream out(argv[2], std::ios::binary);
+    if (!out)
+    {
+        std::cerr << "Ошибка при создании " << argv[2] << "\n";
+        return -1;
+    }
+
+    out << "// Сгенерировано tools/embed_resources.cpp, не редактировать вручную\n\n"
+        << "#pragma once\n\n"
+        << "namespace Embedded\n{\n";
+    writeArray(out, "FONT_DATA", font.data(), font.size());
+    out << "inline constexpr unsigned int LOGO_WIDTH = " << logoSize.x << ";\n"
+        << "inline constexpr unsigned int LOGO_HEIGHT = " << logoSize.y << ";\n\n";
+    writeArray(out, "LOGO_PIXELS", logo.getPixelsPtr(),
+               static_cast<std::size_t>(logoSize.x) * logoSize.y * 4);
+    out << "}\n";
+
+    return out ? 0 : -1;
+}
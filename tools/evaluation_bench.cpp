@@ -0,0 +1,267 @@
+// Генератор нагрузки для сервера вычислений (sfml-calc --serve)
+// Отправляет конвейерные запросы из нескольких соединений и выводит
+// количество запросов в секунду и перцентили задержки
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "../include/EvaluationProtocol.h"
+
+using Clock = std::chrono::steady_clock;
+
+// Параметры нагрузки
+struct Options
+{
+    std::string socketPath = EvaluationProtocol::DEFAULT_SOCKET_PATH;
+    std::string expression = "(1+2)*3-4/5";
+    size_t connections = 4;
+    size_t requests = 100000; // На одно соединение
+    size_t depth = 32;        // Запросов в конвейере
+};
+
+// Результат работы одного соединения
+struct Result
+{
+    std::vector<double> latencies; // Задержки в микросекундах
+    size_t errors = 0;
+};
+
+[[noreturn]] static void throwSystemError(const char *what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+// Подключение к серверу
+static int connectTo(const std::string &path)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path))
+        throw std::invalid_argument("Некорректный путь к сокету");
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        throwSystemError("socket");
+
+    if (::connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0)
+    {
+        int error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), "connect");
+    }
+    return fd;
+}
+
+// Нагрузка из одного соединения: в конвейере держится до depth запросов.
+// Запись и чтение чередуются через poll, поэтому клиент не блокируется на отправке,
+// пока сервер ждет, когда заберут его ответы
+static void runConnection(const Options &options, Result &result)
+{
+    int fd = connectTo(options.socketPath);
+
+    std::string frame;
+    EvaluationProtocol::appendFrame(frame, options.expression);
+
+    std::string output;                      // Запросы, ожидающие отправки
+    size_t outputOffset = 0;                 // Уже отправленная часть output
+    std::string input;                       // Принятые байты ответов
+    std::deque<Clock::time_point> sendTimes; // Время постановки запросов в конвейер
+    std::vector<char> buffer(64 * 1024);
+    result.latencies.reserve(options.requests);
+
+    size_t queued = 0;
+    size_t received = 0;
+    while (received < options.requests)
+    {
+        // Отправленное начало буфера сдвигаем только когда оно занимает большую
+        // часть буфера, иначе каждая частичная отправка копировала бы весь хвост
+        if (outputOffset > 0 && outputOffset >= output.size() / 2)
+        {
+            output.erase(0, outputOffset);
+            outputOffset = 0;
+        }
+
+        // Дополняем конвейер до заданной глубины
+        const Clock::time_point now = Clock::now();
+        while (queued < options.requests && queued - received < options.depth)
+        {
+            output += frame;
+            sendTimes.push_back(now);
+            ++queued;
+        }
+
+        pollfd descriptor{fd, static_cast<short>(POLLIN | (outputOffset < output.size() ? POLLOUT : 0)), 0};
+        if (::poll(&descriptor, 1, -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            throwSystemError("poll");
+        }
+
+        if (descriptor.revents & POLLOUT)
+        {
+            ssize_t sent = ::send(fd, output.data() + outputOffset, output.size() - outputOffset,
+                                  MSG_NOSIGNAL | MSG_DONTWAIT);
+            if (sent < 0 && errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)
+                throwSystemError("send");
+            if (sent > 0)
+                outputOffset += static_cast<size_t>(sent);
+        }
+
+        if (descriptor.revents & (POLLIN | POLLHUP | POLLERR))
+        {
+            ssize_t n = ::recv(fd, buffer.data(), buffer.size(), MSG_DONTWAIT);
+            if (n < 0)
+            {
+                if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)
+                    continue;
+                throwSystemError("recv");
+            }
+            if (n == 0)
+                throw std::runtime_error("Сервер закрыл соединение");
+
+            input.append(buffer.data(), static_cast<size_t>(n));
+            const Clock::time_point arrived = Clock::now();
+
+            size_t offset = 0;
+            std::string_view payload;
+            while (EvaluationProtocol::nextFrame(input, offset, payload))
+            {
+                if (payload.empty() || payload[0] != EvaluationProtocol::STATUS_OK)
+                    ++result.errors;
+                result.latencies.push_back(
+                    std::chrono::duration<double, std::micro>(arrived - sendTimes.front()).count());
+                sendTimes.pop_front();
+                ++received;
+            }
+            input.erase(0, offset);
+        }
+    }
+
+    ::close(fd);
+}
+
+// Значение перцентиля в отсортированном массиве
+static double percentile(const std::vector<double> &sorted, double p)
+{
+    if (sorted.empty())
+        return 0;
+    size_t index = static_cast<size_t>(p / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+static void printUsage()
+{
+    std::cerr << "Использование: evaluation-bench [-s сокет] [-c соединений] [-n запросов на соединение]\n"
+                 "                        [-d глубина конвейера] [-e выражение]\n";
+}
+
+int main(int argc, char *argv[])
+{
+    Options options;
+    try
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            std::string_view arg(argv[i]);
+            if (i + 1 >= argc)
+            {
+                printUsage();
+                return -1;
+            }
+
+            if (arg == "-s")
+                options.socketPath = argv[++i];
+            else if (arg == "-e")
+                options.expression = argv[++i];
+            else if (arg == "-c")
+                options.connections = std::stoul(argv[++i]);
+            else if (arg == "-n")
+                options.requests = std::stoul(argv[++i]);
+            else if (arg == "-d")
+                options.depth = std::stoul(argv[++i]);
+            else
+            {
+                printUsage();
+                return -1;
+            }
+        }
+    }
+    catch (const std::exception &)
+    {
+        printUsage();
+        return -1;
+    }
+
+    if (options.connections == 0 || options.depth == 0 ||
+        options.expression.size() > EvaluationProtocol::MAX_PAYLOAD_SIZE)
+    {
+        printUsage();
+        return -1;
+    }
+
+    std::vector<Result> results(options.connections);
+    std::vector<std::string> failures(options.connections);
+
+    const Clock::time_point start = Clock::now();
+    {
+        std::vector<std::jthread> threads;
+        for (size_t i = 0; i < options.connections; ++i)
+        {
+            threads.emplace_back([&, i]
+                                 {
+                try
+                {
+                    runConnection(options, results[i]);
+                }
+                catch (const std::exception &error)
+                {
+                    failures[i] = error.what();
+                } });
+        }
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    for (const auto &failure : failures)
+    {
+        if (!failure.empty())
+        {
+            std::cerr << "Ошибка: " << failure << "\n";
+            return -1;
+        }
+    }
+
+    std::vector<double> latencies;
+    size_t errors = 0;
+    for (const auto &result : results)
+    {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        errors += result.errors;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    std::cout << "Запросов:        " << latencies.size() << " (ошибок вычисления: " << errors << ")\n"
+              << "Соединений:      " << options.connections << ", глубина конвейера " << options.depth << "\n"
+              << "Время:           " << seconds << " с\n"
+              << "Запросов в сек.: " << static_cast<double>(latencies.size()) / seconds << "\n"
+              << "Задержка, мкс:   p50 " << percentile(latencies, 50)
+              << ", p90 " << percentile(latencies, 90)
+              << ", p99 " << percentile(latencies, 99)
+              << ", p99.9 " << percentile(latencies, 99.9)
+              << ", max " << (latencies.empty() ? 0 : latencies.back()) << "\n";
+    return 0;
+}